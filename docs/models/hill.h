@@ -0,0 +1,57 @@
+// Response-function kernels for QSP models
+//
+// Use with $INCLUDE hill.h
+//
+// The `_k` arguments take a cached tau^k (or ec50^k), which depends only on
+// parameters; compute it once per individual in $MAIN with hill_pow(tau,k)
+// and pass it in from $ODE. Argument names are lower case so they do not
+// collide with model parameters, which mrgsolve defines as macros.
+//
+// hill_pow(x,k) is the exp(k*log(x)) fast path for x > 0; the relative
+// error versus pow() is bounded by roughly (2 + |k*log(x)|) * 1.1e-16,
+// i.e. a few ulp for the exponents and concentrations in these models.
+
+#ifndef HILL_H
+#define HILL_H
+
+#include <cmath>
+#include <algorithm>
+
+inline double hill_pow(double x, double k) {
+  if(x > 0.0) return std::exp(k*std::log(x));
+  return k==0.0 ? 1.0 : 0.0;
+}
+
+// x^k / (tau^k + x^k), x truncated at zero
+inline double hill(double x, double k, double tau_k) {
+  double a = hill_pow(std::max(x,0.0),k);
+  return a/(tau_k + a);
+}
+
+// e_max * x / (ec50 + x)
+inline double emax(double x, double e_max, double ec50) {
+  return e_max*x/(ec50 + x);
+}
+
+// e_max * x^k / (ec50^k + x^k)
+inline double sigmoid_emax(double x, double e_max, double k, double ec50_k) {
+  return e_max*hill(x,k,ec50_k);
+}
+
+// vmax * x / (km + x)
+inline double mm(double x, double vmax, double km) {
+  return vmax*x/(km + x);
+}
+
+// Batched Hill: out[i] = hill(x[i],k,tau_k) for i in [0,n)
+inline void hill_n(const double* x, int n, double k, double tau_k, double* out) {
+  for(int i = 0; i < n; ++i) out[i] = hill(x[i],k,tau_k);
+}
+
+// Original signature, recomputes tau^k on every call
+inline double HillEQ(double x, double k, double tau) {
+  double a = pow(std::max(x,0.0),k);
+  return a/(pow(tau,k) + a);
+}
+
+#endif
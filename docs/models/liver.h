@@ -0,0 +1,66 @@
+// Dispersion-model liver: N well-stirred segments in series
+//
+// Use with $INCLUDE liver.h
+//
+// Each chain works on N contiguous compartments, so declare the segments
+// in order in $CMT / $INIT and pass the first one by address, e.g.
+// liver_chain<NLIV>(&iliv1, &dxdt_iliv1, ...). N is a template parameter,
+// so the loops have a compile-time trip count; raising N only needs more
+// compartments declared, not more equations.
+//
+// Per-segment kernels (uptake, metabolism, elimination) are passed as
+// callables taking the segment index and the segment concentration and
+// returning a flux. Argument names avoid the compartment and parameter
+// names used in the models, which mrgsolve defines as macros.
+
+#ifndef LIVER_H
+#define LIVER_H
+
+// Single-layer chain:
+// dA[i] = s * (qin_i - q*fout*c[i] - elim(i, c[i])), c = A*rv
+// qin_0 = qin, qin_i = q*fout*c[i-1]
+template<int N, class Elim>
+inline void liver_chain(const double* A, double* dA, double rv, double s,
+                        double q, double fout, double qin, Elim elim) {
+  double in = qin;
+  for(int i = 0; i < N; ++i) {
+    double c = A[i]*rv;
+    double out = q*fout*c;
+    dA[i] = s*(in - out - elim(i, c));
+    in = out;
+  }
+}
+
+// Two-layer chain, extracellular (E) and intracellular (C):
+// dE[i] = sE * (qin_i - q*cE[i] - up_i + ex*cC[i])
+// dC[i] = sC * (up_i - ex*cC[i] - met(i, cC[i])), up_i = uptake(i, cE[i])
+// cE = E*rvE, cC = C*rvC, qin_0 = qin, qin_i = q*cE[i-1]
+template<int N, class Uptake, class Met>
+inline void liver_chain2(const double* E, const double* C, double* dE, double* dC,
+                         double rvE, double rvC, double sE, double sC,
+                         double q, double qin, double ex,
+                         Uptake uptake, Met met) {
+  double in = qin;
+  for(int i = 0; i < N; ++i) {
+    double cE = E[i]*rvE;
+    double cC = C[i]*rvC;
+    double up = uptake(i, cE);
+    double eff = ex*cC;
+    dE[i] = sE*(in - q*cE - up + eff);
+    dC[i] = sC*(up - eff - met(i, cC));
+    in = q*cE;
+  }
+}
+
+// Enzyme turnover driven by the intracellular concentration:
+// dR[i] = kdeg * (1 + emax*fu*c[i]/(fu*c[i] + ec50) - R[i])
+template<int N>
+inline void liver_induction(const double* R, double* dR, const double* c,
+                            double kdeg, double emax, double ec50, double fu) {
+  for(int i = 0; i < N; ++i) {
+    double cu = fu*c[i];
+    dR[i] = kdeg*(1 + emax*cu/(cu + ec50) - R[i]);
+  }
+}
+
+#endif
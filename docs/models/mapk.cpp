@@ -1,12 +1,4 @@
-$GLOBAL
-
-//-- #include "global.h"
-//--  Y = (max(0,x).^k)./(tau^k + max(0,x).^k);
-
-double HillEQ(double x, double k, double tau) {
-  double a = pow(std::max(x,0.0),k);
-  return a/(pow(tau,k) + a);
-}
+$INCLUDE hill.h
 
 // Created: Wed Jun 28 11:21:18 2017
 
@@ -117,6 +109,9 @@ r5     = 1    //   param 100
 Gdusp  = 1    //   param 101
 Gspry  = 1    //   param 102
 
+$PARAM
+SS0    = 0    // 1: start FB1..FB4 and TD1 at the pre-dose steady state
+
 $INIT
 // Created: Wed Jun 28 11:21:18 2017
 // Initial conditions (17)
@@ -138,31 +133,156 @@ AKTi_blood  = 0  //   species 30
 MEKi_V3     = 0  //   species 31
 RTK1i_gut   = 0  //   species 32
 
+$MAIN
+// Parameter-only tau^k terms for hill()
+double tauFB1_k = hill_pow(tauFB1, kFB1);
+double tauFB2_k = hill_pow(tauFB2, kFB2);
+double tauFB3_k = hill_pow(tauFB3, kFB3);
+double tauFB4_k = hill_pow(tauFB4, kFB4);
+double tau1_k   = hill_pow(tau1, k1);
+double tau2_k   = hill_pow(tau2, k2);
+double tau3_k   = hill_pow(tau3, k3);
+double tau4_k   = hill_pow(tau4, k4);
+double tau5_k   = hill_pow(tau5, k5);
+double tau6_k   = hill_pow(tau6, k6);
+double tau7_k   = hill_pow(tau7, k7);
+double tau8_k   = hill_pow(tau8, k8);
+double taug_k   = hill_pow(taug, kg);
+double taui1_k  = hill_pow(taui1, ki1);
+double taui2_k  = hill_pow(taui2, ki2);
+double taui3_k  = hill_pow(taui3, ki3);
+double taui4_k  = hill_pow(taui4, ki4);
+double taui5_k  = hill_pow(taui5, ki5);
+
+// Parameter-only PK rate constants and reciprocal volumes
+double rV1 = 1.0 / V1;
+double rV2 = 1.0 / V2;
+double rV3 = 1.0 / V3;
+double rV4 = 1.0 / V4;
+double rV5 = 1.0 / V5;
+double ka1a = ka1 * F1;
+double ka1b = ka1 * (1 - F1);
+double ka2a = ka2 * F2;
+double ka2b = ka2 * (1 - F2);
+double ka3a = ka3 * F3;
+double ka3b = ka3 * (1 - F3);
+double ka4a = ka4 * F4;
+double ka4b = ka4 * (1 - F4);
+double ka5a = ka5 * F5;
+double ka5b = ka5 * (1 - F5);
+double k23 = q2 / V3;
+double k32 = q2 / V3b;
+
+// Pre-dose steady state of the feedback loops, with no drug on board:
+// FB1 = FB2 = FB3 = ERK, FB4 = AKT and TD1 = S6. Solve x = (ERK, AKT)
+// for G(x) = F(x) - x = 0 by Newton; when a Newton step does not reduce
+// |G|, take a pseudo-transient continuation step (I/dt - J) dx = G, and
+// if that fails too, reject it and halve dt. The initial values are only
+// set on convergence; otherwise they keep their zero defaults
+if(NEWIND <= 1 && SS0 > 0) {
+  auto ss_rules = [&](const double* x, double* f) {
+    double ss_hfb3 = hill(x[0], kFB3, tauFB3_k);
+    double ss_hfb4 = hill(x[1], kFB4, tauFB4_k);
+    double ss_RTK1 = RTK1b + (RTK1t - RTK1b) * (1 - G13 * ss_hfb3) * (1 - G14 * ss_hfb4);
+    double ss_RTK2 = RTK2b + (RTK2t - RTK2b) * (1 - G23 * ss_hfb3) * (1 - G24 * ss_hfb4);
+    double ss_RTK3 = RTK3b + (RTK3t - RTK3b) * (1 - G33 * ss_hfb3) * (1 - G34 * ss_hfb4);
+    double ss_RAS  = (RASb + (RASt - RASb) * hill(ss_RTK1 + ss_RTK2, k1, tau1_k)) * (1 - Gspry * hill(x[0], kFB2, tauFB2_k));
+    double ss_BRAF = BRAFb + (BRAFt - BRAFb) * hill(ss_RAS, k2, tau2_k);
+    double ss_CRAF = CRAFb + (CRAFt - CRAFb) * hill(ss_RAS, k5, tau5_k);
+    double ss_MEK  = MEKb + (MEKt - MEKb) * hill(ss_BRAF + ss_CRAF, k3, tau3_k);
+    double ss_PI3K = PI3Kb + (PI3Kt - PI3Kb) * hill(ss_RTK3 + wRAS * ss_RAS, k7, tau7_k);
+    f[0] = (ERKb + (ERKt - ERKb) * hill(ss_MEK, k4, tau4_k)) * (1 - Gdusp * hill(x[0], kFB1, tauFB1_k));
+    f[1] = AKTb + (AKTt - AKTb) * hill(ss_PI3K, k8, tau8_k);
+    f[2] = S6b + (S6t - S6b) * hill(wOR * f[0] + (1 - wOR) * f[1], k6, tau6_k);
+  };
+  auto ss_step = [&](const double* g, const double* J, double s, double* dx) {
+    double ss_det = (s - J[0]) * (s - J[3]) - J[1] * J[2];
+    dx[0] = ((s - J[3]) * g[0] + J[1] * g[1]) / ss_det;
+    dx[1] = ((s - J[0]) * g[1] + J[2] * g[0]) / ss_det;
+  };
+  auto ss_norm = [&](const double* x, const double* f) {
+    return std::max(fabs(f[0] - x[0]), fabs(f[1] - x[1]));
+  };
+  double ss_x[2] = {0.0, 0.0};
+  double ss_f[3], ss_ft[3], ss_g[2], ss_J[4], ss_dx[2], ss_xt[2];
+  double ss_dt = 1.0;
+  ss_rules(ss_x, ss_f);
+  double ss_gn = ss_norm(ss_x, ss_f);
+  double ss_tol = 1e-12 * (1.0 + std::max(fabs(ss_f[0]), fabs(ss_f[1])));
+  for(int it = 0; it < 100 && ss_gn >= ss_tol; ++it) {
+    ss_g[0] = ss_f[0] - ss_x[0];
+    ss_g[1] = ss_f[1] - ss_x[1];
+    for(int j = 0; j < 2; ++j) {
+      ss_xt[0] = ss_x[0];
+      ss_xt[1] = ss_x[1];
+      double ss_h = 1e-7 * (1.0 + fabs(ss_x[j]));
+      ss_xt[j] += ss_h;
+      ss_rules(ss_xt, ss_ft);
+      ss_J[j]     = (ss_ft[0] - ss_xt[0] - ss_g[0]) / ss_h;
+      ss_J[2 + j] = (ss_ft[1] - ss_xt[1] - ss_g[1]) / ss_h;
+    }
+    ss_step(ss_g, ss_J, 0.0, ss_dx);
+    ss_xt[0] = ss_x[0] + ss_dx[0];
+    ss_xt[1] = ss_x[1] + ss_dx[1];
+    ss_rules(ss_xt, ss_ft);
+    double ss_new = ss_norm(ss_xt, ss_ft);
+    if(!(ss_new < ss_gn)) {
+      ss_step(ss_g, ss_J, 1.0 / ss_dt, ss_dx);
+      ss_xt[0] = ss_x[0] + ss_dx[0];
+      ss_xt[1] = ss_x[1] + ss_dx[1];
+      ss_rules(ss_xt, ss_ft);
+      ss_new = ss_norm(ss_xt, ss_ft);
+      // Written so that a NaN norm (singular J, overflow) also rejects
+      if(!(ss_new < ss_gn)) {
+        ss_dt *= 0.5;
+        continue;
+      }
+      ss_dt *= 2.0;
+    }
+    ss_x[0] = ss_xt[0];
+    ss_x[1] = ss_xt[1];
+    ss_f[0] = ss_ft[0];
+    ss_f[1] = ss_ft[1];
+    ss_f[2] = ss_ft[2];
+    ss_gn = ss_new;
+    ss_tol = 1e-12 * (1.0 + std::max(fabs(ss_f[0]), fabs(ss_f[1])));
+  }
+  if(ss_gn < ss_tol) {
+    FB1_0 = ss_x[0];
+    FB2_0 = ss_x[0];
+    FB3_0 = ss_x[0];
+    FB4_0 = ss_x[1];
+    TD1_0 = ss_f[2];
+  }
+}
+
 $ODE
 
 // Created: Wed Jun 28 11:21:18 2017
 // RULES (21)
-double RTK1i_C = RTK1i_blood / V1;
-double RAFi_C  = RAFi_blood / V2;
-double MEKi_C  = MEKi_blood / V3;
-double ERKi_C  = ERKi_blood / V4;
-double AKTi_C  = AKTi_blood / V5;
+double RTK1i_C = RTK1i_blood * rV1;
+double RAFi_C  = RAFi_blood * rV2;
+double MEKi_C  = MEKi_blood * rV3;
+double ERKi_C  = ERKi_blood * rV4;
+double AKTi_C  = AKTi_blood * rV5;
 double RTK1i   = p1 * RTK1i_C;
 double RAFi    = p2 * RAFi_C;
 double MEKi    = p3 * MEKi_C;
 double ERKi    = p4 * ERKi_C;
 double AKTi    = p5 * AKTi_C;
-double RTK1    = (RTK1b + (RTK1t - RTK1b) * (1 - G13 * HillEQ(FB3, kFB3, tauFB3)) * (1 - G14 * HillEQ(FB4, kFB4, tauFB4))) * (1 - HillEQ(RTK1i, ki1, taui1));
-double RTK2    = RTK2b + (RTK2t - RTK2b) * (1 - G23 * HillEQ(FB3, kFB3, tauFB3)) * (1 - G24 * HillEQ(FB4, kFB4, tauFB4));
-double RTK3    = RTK3b + (RTK3t - RTK3b) * (1 - G33 * HillEQ(FB3, kFB3, tauFB3)) * (1 - G34 * HillEQ(FB4, kFB4, tauFB4));
-double RAS     = (RASb + (RASt - RASb) * HillEQ(RTK1 + RTK2, k1, tau1)) * (1 - Gspry * HillEQ(FB2, kFB2, tauFB2));
-double BRAF    = (BRAFb + (BRAFt - BRAFb) * HillEQ(RAS, k2, tau2)) * (1 - HillEQ(RAFi, ki2, taui2));
-double CRAF    = CRAFb + (CRAFt - CRAFb) * HillEQ(RAS, k5, tau5);
-double MEK     = (MEKb + (MEKt - MEKb) * HillEQ(BRAF + CRAF, k3, tau3)) * (1 - HillEQ(MEKi, ki3, taui3));
-double ERK     = (ERKb + (ERKt - ERKb) * HillEQ(MEK, k4, tau4)) * (1 - Gdusp * HillEQ(FB1, kFB1, tauFB1)) * (1 - HillEQ(ERKi, ki4, taui4));
-double PI3K    = PI3Kb + (PI3Kt - PI3Kb) * HillEQ(RTK3 + wRAS * RAS, k7, tau7);
-double AKT     = (AKTb + (AKTt - AKTb) * HillEQ(PI3K, k8, tau8)) * (1 - HillEQ(AKTi, ki5, taui5));
-double S6      = S6b + (S6t - S6b) * HillEQ(wOR * ERK + (1 - wOR) * AKT, k6, tau6);
+double H_FB3   = hill(FB3, kFB3, tauFB3_k);
+double H_FB4   = hill(FB4, kFB4, tauFB4_k);
+double RTK1    = (RTK1b + (RTK1t - RTK1b) * (1 - G13 * H_FB3) * (1 - G14 * H_FB4)) * (1 - hill(RTK1i, ki1, taui1_k));
+double RTK2    = RTK2b + (RTK2t - RTK2b) * (1 - G23 * H_FB3) * (1 - G24 * H_FB4);
+double RTK3    = RTK3b + (RTK3t - RTK3b) * (1 - G33 * H_FB3) * (1 - G34 * H_FB4);
+double RAS     = (RASb + (RASt - RASb) * hill(RTK1 + RTK2, k1, tau1_k)) * (1 - Gspry * hill(FB2, kFB2, tauFB2_k));
+double BRAF    = (BRAFb + (BRAFt - BRAFb) * hill(RAS, k2, tau2_k)) * (1 - hill(RAFi, ki2, taui2_k));
+double CRAF    = CRAFb + (CRAFt - CRAFb) * hill(RAS, k5, tau5_k);
+double MEK     = (MEKb + (MEKt - MEKb) * hill(BRAF + CRAF, k3, tau3_k)) * (1 - hill(MEKi, ki3, taui3_k));
+double ERK     = (ERKb + (ERKt - ERKb) * hill(MEK, k4, tau4_k)) * (1 - Gdusp * hill(FB1, kFB1, tauFB1_k)) * (1 - hill(ERKi, ki4, taui4_k));
+double PI3K    = PI3Kb + (PI3Kt - PI3Kb) * hill(RTK3 + wRAS * RAS, k7, tau7_k);
+double AKT     = (AKTb + (AKTt - AKTb) * hill(PI3K, k8, tau8_k)) * (1 - hill(AKTi, ki5, taui5_k));
+double S6      = S6b + (S6t - S6b) * hill(wOR * ERK + (1 - wOR) * AKT, k6, tau6_k);
 
 // Created: Wed Jun 28 11:21:18 2017
 // Reactions (22)
@@ -170,24 +290,24 @@ double fb1        = r1 * (ERK - FB1);
 double fb2        = r2 * (ERK - FB2);
 double fb3        = r3 * (ERK - FB3);
 double TD         = r5 * (S6 - TD1);
-double cell       = (umax * HillEQ(TD1, kg, taug) - dmax) * CELLS * (1 - CELLS / Vmax);
+double cell       = (umax * hill(TD1, kg, taug_k) - dmax) * CELLS * (1 - CELLS / Vmax);
 double fb4        = r4 * (AKT - FB4);
-double PK1a_RAFi  = ka2 * F2 * RAFi_gut;
-double PK1a_MEKi  = ka3 * F3 * MEKi_gut;
-double PK1a_ERKi  = ka4 * F4 * ERKi_gut;
-double PK1a_AKTi  = ka5 * F5 * AKTi_gut;
+double PK1a_RAFi  = ka2a * RAFi_gut;
+double PK1a_MEKi  = ka3a * MEKi_gut;
+double PK1a_ERKi  = ka4a * ERKi_gut;
+double PK1a_AKTi  = ka5a * AKTi_gut;
 double PK2_RTK1i  = ke1 * RTK1i_blood;
 double PK2_RAFi   = ke2 * RAFi_blood;
 double PK2_MEKi   = ke3 * MEKi_blood;
 double PK2_ERKi   = ke4 * ERKi_blood;
 double PK2_AKTi   = ke5 * AKTi_blood;
-double PK3_MEKi   = q2 / V3 * MEKi_blood - q2 / V3b * MEKi_V3;
-double PK1a_RTK1i = ka1 * F1 * RTK1i_gut;
-double PK1b_RTK1i = ka1 * (1 - F1) * RTK1i_gut;
-double PK1b_RAFi  = ka2 * (1 - F2) * RAFi_gut;
-double PK1b_MEKi  = ka3 * (1 - F3) * MEKi_gut;
-double PK1b_ERKi  = ka4 * (1 - F4) * ERKi_gut;
-double PK1b_AKTi  = ka5 * (1 - F5) * AKTi_gut;
+double PK3_MEKi   = k23 * MEKi_blood - k32 * MEKi_V3;
+double PK1a_RTK1i = ka1a * RTK1i_gut;
+double PK1b_RTK1i = ka1b * RTK1i_gut;
+double PK1b_RAFi  = ka2b * RAFi_gut;
+double PK1b_MEKi  = ka3b * MEKi_gut;
+double PK1b_ERKi  = ka4b * ERKi_gut;
+double PK1b_AKTi  = ka5b * AKTi_gut;
 
 
 // Created: Wed Jun 28 11:21:18 2017
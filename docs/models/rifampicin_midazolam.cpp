@@ -9,6 +9,16 @@ ahead of print] PubMed PMID: 29368402.
 https://www.ncbi.nlm.nih.gov/pubmed/29368402
 http://onlinelibrary.wiley.com/doi/10.1002/psp4.12275/abstract
 
+Coupling: rifampicin drives midazolam only through `CYP3A4_ratio_HC1..5`
+and `CYP3A4_ratio_ent`; nothing feeds back from midazolam to rifampicin
+
+[ GLOBAL ]
+// Liver segments; CHE, CHC, CLIV and the HC enzyme ratios each declare
+// NLIV compartments in order
+#define NLIV 5
+
+[ INCLUDE ] liver.h
+
 [ PARAM ]
 
 Rdif  = 0.129
@@ -142,6 +152,28 @@ if(NEWIND <= 1) {
   double Qgut = fE * PSdif_E * Qvilli / (Qvilli + fB * PSdif_E);
   double mQgut = Qvilli * mCLperm_gut / (Qvilli + mCLperm_gut);
   double CLint_E = (Qgut * (1.0 / Fg - 1.0) - (1.0- Fa) * fE * PSdif_E * 20.0) / fE;
+  // -------------------------------------------
+  double rKp_muscle   = 1.0 / (SFKp * Kp_muscle);
+  double rKp_skin     = 1.0 / (SFKp * Kp_skin);
+  double rKp_adipose  = 1.0 / (SFKp * Kp_adipose);
+  double rKp_serosa   = 1.0 / (SFKp * Kp_serosa);
+  double mrKp_liver   = 1.0 / (mSFKp * mKp_liver);
+  double mrKp_muscle  = 1.0 / (mSFKp * mKp_muscle);
+  double mrKp_skin    = 1.0 / (mSFKp * mKp_skin);
+  double mrKp_adipose = 1.0 / (mSFKp * mKp_adipose);
+  // -------------------------------------------
+  double rVcentral  = 1.0 / Vcentral;
+  double rmVcentral = 1.0 / mVcentral;
+  double rVmuscle   = 1.0 / Vmuscle;
+  double rVskin     = 1.0 / Vskin;
+  double rVadipose  = 1.0 / Vadipose;
+  double rVserosa   = 1.0 / Vserosa;
+  double rVmucblood = 1.0 / Vmucblood;
+  double rVent      = 1.0 / Vent;
+  double rVportal   = 1.0 / Vportal;
+  double rdVHE      = NLIV / VHE;
+  double rdVHC      = NLIV / VHC;
+  double rdVLIV     = NLIV / (VHE + VHC);
 }
 
 [CMT]
@@ -169,37 +201,45 @@ CYP3A4_ratio_HC4 = 1
 CYP3A4_ratio_HC5 = 1
 CYP3A4_ratio_ent = 1
 
+// Running midazolam AUC (ng*h/mL); last in the list so dosing
+// compartments and the state order above are unchanged
+[ CMT ] AUCmid
+
 [ ODE ]
 
-double Ccentral = central/Vcentral;
+double Ccentral = central * rVcentral;
+
+// Outflow from the last liver segment
+double CHEN = (&CHE1)[NLIV-1];
+double CLIVN = (&CLIV1)[NLIV-1];
 
 dxdt_central = 
-  Qh       * CHE5 - 
+  Qh       * CHEN - 
   Qhart    * Ccentral - 
   Qserosa  * Ccentral - 
   Qvilli   * Ccentral - 
   CLrenal  * Ccentral + 
-  Qmuscle  * (Cmuscle  / (SFKp * Kp_muscle)  - Ccentral) + 
-  Qskin    * (Cskin    / (SFKp * Kp_skin)    - Ccentral) + 
-  Qadipose * (Cadipose / (SFKp * Kp_adipose) - Ccentral);
+  Qmuscle  * (Cmuscle  * rKp_muscle  - Ccentral) + 
+  Qskin    * (Cskin    * rKp_skin    - Ccentral) + 
+  Qadipose * (Cadipose * rKp_adipose - Ccentral);
 
 dxdt_Cmuscle = 
-  (1.0/Vmuscle) * Qmuscle * (Ccentral - Cmuscle / (SFKp * Kp_muscle));
+  rVmuscle * Qmuscle * (Ccentral - Cmuscle * rKp_muscle);
 
 dxdt_Cskin = 
-  (1.0/Vskin) * Qskin * (Ccentral - Cskin / (SFKp * Kp_skin));
+  rVskin * Qskin * (Ccentral - Cskin * rKp_skin);
 
 dxdt_Cadipose = 
-  (1.0/Vadipose) * Qadipose * (Ccentral - Cadipose / (SFKp * Kp_adipose));
+  rVadipose * Qadipose * (Ccentral - Cadipose * rKp_adipose);
 
 dxdt_Cserosa = 
-  (1.0/Vserosa) * Qserosa * (Ccentral - Cserosa / (SFKp * Kp_serosa));
+  rVserosa * Qserosa * (Ccentral - Cserosa * rKp_serosa);
 
 dxdt_Cmucblood = 
   Qvilli * (Ccentral - Cmucblood) + 
   fE * PSdif_E * Cent - fB * PSdif_E * Cmucblood;
 
-dxdt_Cmucblood = dxdt_Cmucblood * (1/Vmucblood);
+dxdt_Cmucblood = dxdt_Cmucblood * rVmucblood;
 
 dxdt_Xgutlumen = 
   - ka / Fa * Xgutlumen + fE * PSdif_E * 20 * Cent;
@@ -210,179 +250,74 @@ dxdt_Cent =
   fE * (PSdif_E * 21 + 
   CLint_E * (1 + fm_UGT_ent * (UGT_ratio_ent - 1))) * Cent;
 
-dxdt_Cent = dxdt_Cent * (1/Vent);
+dxdt_Cent = dxdt_Cent * rVent;
 
-dxdt_UGT_ratio_HC1 = 
-  kdeg_UGT_liver * 
-  (1 + Emax_UGT_RIF * fH * CHC1 / (fH * CHC1 + EC50_u_UGT_RIF) - UGT_ratio_HC1);
-
-dxdt_UGT_ratio_HC2 = 
-  kdeg_UGT_liver * 
-  (1 + Emax_UGT_RIF * fH * CHC2 / (fH * CHC2 + EC50_u_UGT_RIF) - UGT_ratio_HC2);
-
-dxdt_UGT_ratio_HC3 = 
-  kdeg_UGT_liver *
-  (1 + Emax_UGT_RIF * fH * CHC3 / (fH * CHC3 + EC50_u_UGT_RIF) - UGT_ratio_HC3);
-
-dxdt_UGT_ratio_HC4 = 
-  kdeg_UGT_liver * 
-  (1 + Emax_UGT_RIF * fH * CHC4 / (fH * CHC4 + EC50_u_UGT_RIF) - UGT_ratio_HC4);
-
-dxdt_UGT_ratio_HC5 = 
-  kdeg_UGT_liver * 
-  (1 + Emax_UGT_RIF * fH * CHC5 / (fH * CHC5 + EC50_u_UGT_RIF) - UGT_ratio_HC5);
+liver_induction<NLIV>(
+  &UGT_ratio_HC1, &dxdt_UGT_ratio_HC1, &CHC1,
+  kdeg_UGT_liver, Emax_UGT_RIF, EC50_u_UGT_RIF, fH
+);
 
 dxdt_UGT_ratio_ent = 
   kdeg_UGT_ent * 
   (1 + Emax_UGT_RIF * fE * Cent / (fE * Cent + EC50_u_UGT_RIF) - UGT_ratio_ent);
 
-dxdt_CHE1 = 
-  Qhart  * Ccentral + 
-  Qvilli * Cmucblood + 
-  Qserosa * Cserosa / (SFKp * Kp_serosa) - 
-  Qh * CHE1 + 
-  (fH * PSdif_eff * CHC1 - 
-   fB * (Vmax_uptake / (Km_u_uptake + fB * CHE1) + PSdif_inf) * CHE1) / 5.0;   
-
-dxdt_CHE1 = dxdt_CHE1 * (5.0/VHE);
-
-dxdt_CHE2 = 
-  Qh * (CHE1 - CHE2) + 
-  (fH * PSdif_eff * CHC2 - 
-   fB * (Vmax_uptake / (Km_u_uptake + fB * CHE2) + PSdif_inf) * CHE2) / 5.0;
-
-dxdt_CHE2 = dxdt_CHE2 * (5.0/VHE);
-
-dxdt_CHE3 = 
-  Qh * (CHE2 - CHE3) + 
-  (fH * PSdif_eff * CHC3 - 
-   fB * (Vmax_uptake / (Km_u_uptake + fB * CHE3) + PSdif_inf) * CHE3) / 5.0;
-
-dxdt_CHE3 = dxdt_CHE3 * (5.0/VHE);
-
-dxdt_CHE4 = 
-  Qh * (CHE3 - CHE4) + 
-  (fH * PSdif_eff * CHC4 - 
-   fB * (Vmax_uptake / (Km_u_uptake + fB * CHE4) + PSdif_inf) * CHE4) / 5.0;
-
-dxdt_CHE4 = dxdt_CHE4 * (5.0/VHE);
-
-dxdt_CHE5 = 
-  Qh * (CHE4 - CHE5) + 
-  (fH * PSdif_eff * CHC5 - 
-   fB * (Vmax_uptake / (Km_u_uptake + fB * CHE5) + PSdif_inf) * CHE5) / 5.0;// (i = 2~5)
-
-dxdt_CHE5 = dxdt_CHE5 * (5.0/VHE);
-
-dxdt_CHC1 = 
-  (5.0/VHC) *
-  (fB * (Vmax_uptake / (Km_u_uptake + fB * CHE1) + PSdif_inf) * CHE1 - 
-   fH * PSdif_eff * CHC1 - 
-   fH * CLint * (1 + fm_UGT_liver * (UGT_ratio_HC1 - 1)) * CHC1) / 5.0;
-
-dxdt_CHC2 = 
-  (5.0/VHC) *
-  (fB * (Vmax_uptake / (Km_u_uptake + fB * CHE2) + PSdif_inf) * CHE2 - 
-   fH * PSdif_eff * CHC2 - 
-   fH * CLint * (1 + fm_UGT_liver * (UGT_ratio_HC2 - 1)) * CHC2) / 5.0;
-
-dxdt_CHC3 = 
-  (5.0/VHC) *
-  (fB * (Vmax_uptake / (Km_u_uptake + fB * CHE3) + PSdif_inf) * CHE3 - 
-   fH * PSdif_eff * CHC3 - 
-   fH * CLint * (1 + fm_UGT_liver * (UGT_ratio_HC3 - 1)) * CHC3) / 5.0;
-
-dxdt_CHC4 = 
-  (5.0/VHC) * 
-  (fB * (Vmax_uptake / (Km_u_uptake + fB * CHE4) + PSdif_inf) * CHE4 - 
-   fH * PSdif_eff * CHC4 -
-   fH * CLint * (1 + fm_UGT_liver * (UGT_ratio_HC4 - 1)) * CHC4) / 5.0;
-
-dxdt_CHC5 = 
-  (5.0/VHC) *
-  (fB * (Vmax_uptake / (Km_u_uptake + fB * CHE5) + PSdif_inf) * CHE5 - 
-   fH * PSdif_eff * CHC5 - 
-   fH * CLint * (1 + fm_UGT_liver * (UGT_ratio_HC5 - 1)) * CHC5) / 5.0;
-
-double mCcentral = mcentral/mVcentral;
+// Rifampicin liver: saturable OATP uptake, UGT-induced metabolism
+const double* UGT_ratio_HC = &UGT_ratio_HC1;
+liver_chain2<NLIV>(
+  &CHE1, &CHC1, &dxdt_CHE1, &dxdt_CHC1, 1.0, 1.0, rdVHE, rdVHC, Qh,
+  Qhart * Ccentral + Qvilli * Cmucblood + Qserosa * Cserosa * rKp_serosa,
+  fH * PSdif_eff / NLIV,
+  [&](int i, double c) {
+    return fB * (Vmax_uptake / (Km_u_uptake + fB * c) + PSdif_inf) * c / NLIV;
+  },
+  [&](int i, double c) {
+    return fH * CLint * (1 + fm_UGT_liver * (UGT_ratio_HC[i] - 1)) * c / NLIV;
+  }
+);
+
+double mCcentral = mcentral * rmVcentral;
 dxdt_mcentral = 
-  Qh * (CLIV5 / (mSFKp * mKp_liver)) - 
+  Qh * (CLIVN * mrKp_liver) - 
   (Qh-Qportal) * mCcentral +
-  Qmuscle      * (mCmuscle  / (mSFKp * mKp_muscle)  - mCcentral) + 
-  Qskin        * (mCskin    / (mSFKp * mKp_skin)    - mCcentral) +
-  Qadipose     * (mCadipose / (mSFKp * mKp_adipose) - mCcentral) -
+  Qmuscle      * (mCmuscle  * mrKp_muscle  - mCcentral) + 
+  Qskin        * (mCskin    * mrKp_skin    - mCcentral) +
+  Qadipose     * (mCadipose * mrKp_adipose - mCcentral) -
   Qportal      * mCcentral - 
   mCLrenal     * mCcentral;
 
-dxdt_CYP3A4_ratio_HC1 =
-  kdeg_CYP3A4_liver *
-  (1 + Emax_CYP3A4_RIF * fH * CHC1 / (fH * CHC1 + EC50_u_CYP3A4_RIF) - CYP3A4_ratio_HC1);
-dxdt_CYP3A4_ratio_HC2 =
-  kdeg_CYP3A4_liver *
-  (1 + Emax_CYP3A4_RIF * fH * CHC2 / (fH * CHC2 + EC50_u_CYP3A4_RIF) - CYP3A4_ratio_HC2);
-dxdt_CYP3A4_ratio_HC3 =
-  kdeg_CYP3A4_liver *
-  (1 + Emax_CYP3A4_RIF * fH * CHC3 / (fH * CHC3 + EC50_u_CYP3A4_RIF) - CYP3A4_ratio_HC3);
-dxdt_CYP3A4_ratio_HC4 =
-  kdeg_CYP3A4_liver *
-  (1 + Emax_CYP3A4_RIF * fH * CHC4 / (fH * CHC4 + EC50_u_CYP3A4_RIF) - CYP3A4_ratio_HC4);
-dxdt_CYP3A4_ratio_HC5 =
-  kdeg_CYP3A4_liver *
-  (1 + Emax_CYP3A4_RIF * fH * CHC5 / (fH * CHC5 + EC50_u_CYP3A4_RIF) - CYP3A4_ratio_HC5);
+liver_induction<NLIV>(
+  &CYP3A4_ratio_HC1, &dxdt_CYP3A4_ratio_HC1, &CHC1,
+  kdeg_CYP3A4_liver, Emax_CYP3A4_RIF, EC50_u_CYP3A4_RIF, fH
+);
 dxdt_CYP3A4_ratio_ent = 
   kdeg_CYP3A4_ent * 
   (1 + Emax_CYP3A4_RIF * fE * Cent / (fE * Cent + EC50_u_CYP3A4_RIF) - CYP3A4_ratio_ent);
           
-dxdt_CLIV1 = 
-  (Qh-Qportal) * mCcentral + 
-  Qportal * Cportal - 
-  Qh * CLIV1 / (mSFKp * mKp_liver) - 
-  mfBCLint * (1 + fm_CYP3A4_liver * (CYP3A4_ratio_HC1 - 1)) / 5 * CLIV1 / 
-  (mSFKp * mKp_liver);
-
-dxdt_CLIV1 = dxdt_CLIV1 * (5/(VHE+VHC));
-  
-dxdt_CLIV2 = 
-  (Qh * (CLIV1 - CLIV2) - 
-   mfBCLint * (1 + fm_CYP3A4_liver * (CYP3A4_ratio_HC2 - 1)) / 5 * CLIV2) / 
-   (mSFKp * mKp_liver); 
-  
-dxdt_CLIV2 = dxdt_CLIV2 * (5/(VHE+VHC));   
- 
-dxdt_CLIV3 = 
-  (Qh * (CLIV2 - CLIV3) - 
-  mfBCLint * (1 + fm_CYP3A4_liver * (CYP3A4_ratio_HC3 - 1)) / 5 * CLIV3) / 
-  (mSFKp * mKp_liver); 
- 
-dxdt_CLIV3 = dxdt_CLIV3 * (5/(VHE+VHC));   
- 
-dxdt_CLIV4 = 
-  (Qh * (CLIV3 - CLIV4) - 
-  mfBCLint * (1 + fm_CYP3A4_liver * (CYP3A4_ratio_HC4 - 1)) / 5 * CLIV4) / 
-  (mSFKp * mKp_liver); 
- 
-dxdt_CLIV4 = dxdt_CLIV4 * (5/(VHE+VHC));    
-
-dxdt_CLIV5 = 
-  (Qh * (CLIV4 - CLIV5) - 
-  mfBCLint * (1 + fm_CYP3A4_liver * (CYP3A4_ratio_HC5 - 1)) / 5 * CLIV5) / 
-  (mSFKp * mKp_liver); 
-
-dxdt_CLIV5 = dxdt_CLIV5 * (5/(VHE+VHC));    
+// Midazolam liver: CYP3A4-induced metabolism
+const double* CYP3A4_ratio_HC = &CYP3A4_ratio_HC1;
+liver_chain<NLIV>(
+  &CLIV1, &dxdt_CLIV1, 1.0, rdVLIV, Qh, mrKp_liver,
+  (Qh-Qportal) * mCcentral + Qportal * Cportal,
+  [&](int i, double c) {
+    return mfBCLint * (1 + fm_CYP3A4_liver * (CYP3A4_ratio_HC[i] - 1)) / NLIV * c * mrKp_liver;
+  }
+);
 
 dxdt_Cportal = 
   Qportal * (mCcentral - Cportal) + 
   mka * mQgut / (mQgut + mfECLint_E * (1 + fm_CYP3A4_ent * (CYP3A4_ratio_ent - 1))) * Mgutlumen; 
-dxdt_Cportal = dxdt_Cportal * (1/Vportal); 
+dxdt_Cportal = dxdt_Cportal * rVportal; 
   
 dxdt_mCmuscle = 
-  (1/Vmuscle) * Qmuscle * (mCcentral - mCmuscle / (mSFKp * mKp_muscle));
+  rVmuscle * Qmuscle * (mCcentral - mCmuscle * mrKp_muscle);
 
 dxdt_mCskin = 
-  (1/Vskin) * Qskin * (mCcentral - mCskin / (mSFKp * mKp_skin));
+  rVskin * Qskin * (mCcentral - mCskin * mrKp_skin);
 
 dxdt_mCadipose = 
-  (1/Vadipose) * Qadipose * (mCcentral - mCadipose / (mSFKp * mKp_adipose));
+  rVadipose * Qadipose * (mCcentral - mCadipose * mrKp_adipose);
 
 dxdt_Mgutlumen = -mka/mFa * Mgutlumen;
 
+dxdt_AUCmid = 1000 * mCcentral;
+
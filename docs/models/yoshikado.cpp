@@ -9,6 +9,14 @@ Modeling With a Parameter Optimiaztion Method__
 - Reference: CP\&T vol. 100 no. 5 pp. 513-23 11/2016
 - Parameters: 40
 - Compartments: 31
+- Coupling: CsA states drive the statin states only through `csai` in each
+  liver segment; nothing feeds back from statin to CsA
+
+[GLOBAL]
+// Liver segments; he, hc and iliv each declare NLIV compartments in order
+#define NLIV 5
+
+[INCLUDE] liver.h
 
 [CMT] 
 
@@ -96,8 +104,21 @@ if(NEWIND <=1) {
   double Vmc = Vmus-Vme;
   double Vac = Vadi-Vae;
   double Vsc = Vski-Vse;
-  double dVliv = Vliv/5.0;
+  double dVliv = Vliv/NLIV;
   double ikitot = imw*ikiu/ifb;
+
+  double Vhe = dVliv*exFliv;
+  double Vhc = dVliv*(1-exFliv);
+  double rVhe = 1.0/Vhe;
+  double rVhc = 1.0/Vhc;
+  double rdVliv = 1.0/dVliv;
+  double hex2 = fh*(PSdiffe/NLIV);
+  double hmet = fh*(CLint/NLIV);
+  double fbPSact = fb*PSact/NLIV;
+  double fbPSdiffi = fb*PSdiffi/NLIV;
+  double rKpki = 1.0/(iKp_liv*ikitot);
+  double irKp_liv = 1.0/iKp_liv;
+  double ifhCLintn = ifhCLint/NLIV;
 }
 
 // ALAG_gut = tlag;
@@ -111,21 +132,8 @@ double Cmus  = mus/Vmus;
 double Cski  = ski/Vski;
 double Cadi  = adi/Vadi;
 
-// Volume liv
-double Vhe = dVliv*exFliv;
-double Vhc = dVliv*(1-exFliv);
-
-double Chc1 = hc1/Vhc;
-double Chc2 = hc2/Vhc;
-double Chc3 = hc3/Vhc;
-double Chc4 = hc4/Vhc;
-double Chc5 = hc5/Vhc;
-
-double Che1 = he1/Vhe;
-double Che2 = he2/Vhe;
-double Che3 = he3/Vhe;
-double Che4 = he4/Vhe;
-double Che5 = he5/Vhe;
+// Outflow from the last liver segment
+double CheN = (&he1)[NLIV-1]*rVhe;
 
 // CsA concentrations
 double iCcent = icent/Vcent;
@@ -138,16 +146,12 @@ double Cmc = mc/Vmc;
 double Csc = sc/Vsc;
 double Cac = ac/Vac;
 
-double iCliv1 = iliv1/dVliv;
-double iCliv2 = iliv2/dVliv;
-double iCliv3 = iliv3/dVliv;
-double iCliv4 = iliv4/dVliv;
-double iCliv5 = iliv5/dVliv;
+double iClivN = (&iliv1)[NLIV-1]*rdVliv;
 
 dxdt_igut = -ika/ifafg*igut;
 
 dxdt_icent = 
-  Qh*iCliv5/iKp_liv 
+  Qh*iClivN/iKp_liv 
   - Qh*iCcent 
   - iClr*iCcent 
   - Qmus*(iCcent-Cme) 
@@ -162,37 +166,27 @@ dxdt_mc = PSmus*ifb*(Cme-Cmc/iKp_mus);
 dxdt_sc = PSski*ifb*(Cse-Csc/iKp_ski);
 dxdt_ac = PSadi*ifb*(Cae-Cac/iKp_adi);
   
-dxdt_iliv1 = Qh*(iCcent-iCliv1/iKp_liv) - (ifhCLint/5.0)*iCliv1 + ika*igut;
-dxdt_iliv2 = Qh*(iCliv1-iCliv2)/iKp_liv - (ifhCLint/5.0)*iCliv2;
-dxdt_iliv3 = Qh*(iCliv2-iCliv3)/iKp_liv - (ifhCLint/5.0)*iCliv3;
-dxdt_iliv4 = Qh*(iCliv3-iCliv4)/iKp_liv - (ifhCLint/5.0)*iCliv4;
-dxdt_iliv5 = Qh*(iCliv4-iCliv5)/iKp_liv - (ifhCLint/5.0)*iCliv5;
-  
-// CsA effect on Statin
-double csai1 = 1.0+(iCliv1/iKp_liv)/ikitot;
-double csai2 = 1.0+(iCliv2/iKp_liv)/ikitot;
-double csai3 = 1.0+(iCliv3/iKp_liv)/ikitot;
-double csai4 = 1.0+(iCliv4/iKp_liv)/ikitot;
-double csai5 = 1.0+(iCliv5/iKp_liv)/ikitot;
-
-
-double hex2 = fh*(PSdiffe/5.0);
-dxdt_he1 = Qh*(Ccent-Che1)-(fb*(PSact/csai1+PSdiffi)/5.0)*Che1+hex2*Chc1 + ka*gut;
-dxdt_he2 = Qh*(Che1 -Che2)-(fb*(PSact/csai2+PSdiffi)/5.0)*Che2+hex2*Chc2;
-dxdt_he3 = Qh*(Che2 -Che3)-(fb*(PSact/csai3+PSdiffi)/5.0)*Che3+hex2*Chc3;
-dxdt_he4 = Qh*(Che3 -Che4)-(fb*(PSact/csai4+PSdiffi)/5.0)*Che4+hex2*Chc4;
-dxdt_he5 = Qh*(Che4 -Che5)-(fb*(PSact/csai5+PSdiffi)/5.0)*Che5+hex2*Chc5;
-
-
-double hcx2 = fh*((PSdiffe+CLint)/5.0);
-dxdt_hc1 = fb*((PSact/csai1+PSdiffi)/5.0)*Che1 - hcx2*Chc1;
-dxdt_hc2 = fb*((PSact/csai2+PSdiffi)/5.0)*Che2 - hcx2*Chc2;
-dxdt_hc3 = fb*((PSact/csai3+PSdiffi)/5.0)*Che3 - hcx2*Chc3;
-dxdt_hc4 = fb*((PSact/csai4+PSdiffi)/5.0)*Che4 - hcx2*Chc4;
-dxdt_hc5 = fb*((PSact/csai5+PSdiffi)/5.0)*Che5 - hcx2*Chc5;
+// CsA liver
+liver_chain<NLIV>(
+  &iliv1, &dxdt_iliv1, rdVliv, 1.0, Qh, irKp_liv, Qh*iCcent,
+  [&](int i, double c) { return ifhCLintn*c; }
+);
+dxdt_iliv1 += ika*igut;
+
+// Statin liver; CsA in each segment inhibits uptake through csai
+const double* iliv = &iliv1;
+liver_chain2<NLIV>(
+  &he1, &hc1, &dxdt_he1, &dxdt_hc1, rVhe, rVhc, 1.0, 1.0, Qh, Qh*Ccent, hex2,
+  [&](int i, double c) {
+    double csai = 1.0+iliv[i]*rdVliv*rKpki;
+    return (fbPSact/csai+fbPSdiffi)*c;
+  },
+  [&](int i, double c) { return hmet*c; }
+);
+dxdt_he1 += ka*gut;
 
 dxdt_cent = 
-  Qh*Che5 
+  Qh*CheN 
   - Qh*Ccent 
   - CLr*Ccent 
   - Qmus*(Ccent-Cmus/Kp_mus) 
@@ -205,7 +199,9 @@ dxdt_adi = Qadi*(Ccent-Cadi/Kp_adi);
 
 
 dxdt_gut  = ktr*ehc3 - ka/fafg*gut;
-dxdt_ehc1 = fbile*fh*(CLint/5.0)*(Chc1+Chc2+Chc3+Chc4+Chc5)-ktr*ehc1;
+double sumhc = 0;
+for(int i = 0; i < NLIV; ++i) sumhc += (&hc1)[i];
+dxdt_ehc1 = fbile*hmet*sumhc*rVhc-ktr*ehc1;
 dxdt_ehc2 = ktr*(ehc1-ehc2);
 dxdt_ehc3 = ktr*(ehc2-ehc3);
 